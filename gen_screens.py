@@ -0,0 +1,341 @@
+#!/usr/bin/env python3
+#
+#  gen_screens.py - Compile screens.yaml into const screen tables.
+#
+#  Emits screens_gen.h, screens_gen.c and a screens_gen.d depfile.  All
+#  alignment is resolved here, mirroring lv_obj_align_to() against the
+#  parent screen, so the runtime only creates objects and places them with
+#  lv_obj_set_pos().  The font metrics used for label sizes are tied to the
+#  Kconfig default font by a BUILD_ASSERT in screens_gen.c.
+#
+#  usage: gen_screens.py <screens.yaml> <icon source dir> <output dir>
+#
+
+import os
+import re
+import sys
+
+import yaml
+
+IDENT = re.compile(r"^[A-Za-z_][A-Za-z0-9_]*$")
+
+# param_t and screen_values are 'short'
+SHORT_MIN = -32768
+SHORT_MAX = 32767
+
+# display_param_update() formats labels into a 4-byte buffer ("%u")
+LABEL_MAX = 999
+
+ALIGNS = {
+    #                 x-anchor  y-anchor
+    "TOP_LEFT":      ("left",   "top"),
+    "TOP_MID":       ("mid",    "top"),
+    "TOP_RIGHT":     ("right",  "top"),
+    "LEFT_MID":      ("left",   "mid"),
+    "CENTER":        ("mid",    "mid"),
+    "RIGHT_MID":     ("right",  "mid"),
+    "BOTTOM_LEFT":   ("left",   "bottom"),
+    "BOTTOM_MID":    ("mid",    "bottom"),
+    "BOTTOM_RIGHT":  ("right",  "bottom"),
+}
+
+KINDS = {
+    "label":  "SCREEN_ELEM_LABEL",
+    "slider": "SCREEN_ELEM_SLIDER",
+    "image":  "SCREEN_ELEM_IMAGE",
+}
+
+
+def fail(msg):
+    sys.exit("gen_screens: error: " + msg)
+
+
+def anchor(pos, base, size):
+    # Same integer arithmetic as lv_obj_align_to().
+    if pos in ("left", "top"):
+        return 0
+    if pos == "mid":
+        return base // 2 - size // 2
+    return base - size
+
+
+def icon_size(icon_dir, name):
+    path = os.path.join(icon_dir, name + ".c")
+    try:
+        with open(path) as f:
+            src = f.read()
+    except OSError:
+        fail("image '%s': cannot read %s" % (name, path))
+
+    w = re.search(r"\.header\.w\s*=\s*(\d+)", src)
+    h = re.search(r"\.header\.h\s*=\s*(\d+)", src)
+    if not w or not h:
+        fail("image '%s': no header.w/header.h in %s" % (name, path))
+    return int(w.group(1)), int(h.group(1))
+
+
+def c_string(text):
+    return '"' + text.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def require(obj, key, where, kind=None):
+    if not isinstance(obj, dict) or key not in obj:
+        fail("%s: missing '%s'" % (where, key))
+    value = obj[key]
+    if kind is not None and not isinstance(value, kind):
+        fail("%s: '%s' has the wrong type" % (where, key))
+    return value
+
+
+def compile_layout(layout, icon_dir):
+    display = require(layout, "display", "screens.yaml", dict)
+    font = require(layout, "font", "screens.yaml", dict)
+    disp_w = require(display, "width", "display", int)
+    disp_h = require(display, "height", "display", int)
+    font_w = require(font, "width", "font", int)
+    font_h = require(font, "height", "font", int)
+    font_kconfig = require(font, "kconfig", "font", str)
+    if not IDENT.match(font_kconfig):
+        fail("font: kconfig '%s' is not a valid symbol" % font_kconfig)
+
+    screens = []
+    images = []
+    ids = set()
+    param_index = 0
+
+    scr_list = require(layout, "screens", "screens.yaml", list)
+    if not scr_list:
+        fail("no screens defined")
+
+    for n, scr in enumerate(scr_list):
+        name = require(scr, "name", "screen #%d" % n, str)
+        if not IDENT.match(name):
+            fail("screen '%s': name is not a valid C identifier" % name)
+        if name.upper() in ids:
+            fail("screen '%s': duplicate name" % name)
+        ids.add(name.upper())
+        where = "screen '%s'" % name
+
+        elems = []
+        params = []
+
+        items = require(scr, "elements", where, list)
+        if len(items) > 255:
+            fail("%s: too many elements (%d)" % (where, len(items)))
+
+        for item in items:
+            if not isinstance(item, dict) or len(item) != 1:
+                fail("%s: element must have exactly one kind" % where)
+            kind, spec = next(iter(item.items()))
+            if kind not in KINDS:
+                fail("%s: unknown element kind '%s'" % (where, kind))
+            if not isinstance(spec, dict):
+                fail("%s: %s needs a mapping" % (where, kind))
+            ewhere = "%s %s" % (where, kind)
+
+            param = spec.get("param")
+            text = spec.get("text")
+            src = None
+
+            if param is not None:
+                pwhere = ewhere + " param"
+                for key in ("value", "step", "min", "max"):
+                    value = require(param, key, pwhere, int)
+                    if not SHORT_MIN <= value <= SHORT_MAX:
+                        fail("%s: %s %d does not fit in a short" % (pwhere, key, value))
+                if param["min"] > param["max"]:
+                    fail("%s: min > max" % pwhere)
+                if not param["min"] <= param["value"] <= param["max"]:
+                    fail("%s: value %d outside [%d, %d]" %
+                         (pwhere, param["value"], param["min"], param["max"]))
+                if param["step"] <= 0:
+                    fail("%s: step must be > 0" % pwhere)
+                if kind == "label" and (param["min"] < 0 or param["max"] > LABEL_MAX):
+                    fail("%s: label range must be within [0, %d]" % (pwhere, LABEL_MAX))
+
+            if kind == "slider":
+                if param is None:
+                    fail("%s: slider needs a param" % ewhere)
+                w = require(spec, "width", ewhere, int)
+                h = require(spec, "height", ewhere, int)
+            elif kind == "image":
+                src = require(spec, "src", ewhere, str)
+                if not IDENT.match(src):
+                    fail("%s: src '%s' is not a valid C identifier" % (ewhere, src))
+                w, h = icon_size(icon_dir, src)
+                if src not in images:
+                    images.append(src)
+            else:
+                if param is not None:
+                    if text is not None:
+                        fail("%s: param label cannot have text" % ewhere)
+                    text = str(param["value"])
+                if text is None:
+                    fail("%s: label needs text or param" % ewhere)
+                w, h = font_w * len(str(text)), font_h
+
+            align = spec.get("align", "TOP_LEFT")
+            if align not in ALIGNS:
+                fail("%s: unknown align '%s'" % (ewhere, align))
+            offset = spec.get("offset", [0, 0])
+            if not isinstance(offset, list) or len(offset) != 2 or \
+               not all(isinstance(v, int) for v in offset):
+                fail("%s: offset must be [x, y]" % ewhere)
+            ofs_x, ofs_y = offset
+            ax, ay = ALIGNS[align]
+
+            elem = {
+                "kind":  kind,
+                "x":     anchor(ax, disp_w, w) + ofs_x,
+                "y":     anchor(ay, disp_h, h) + ofs_y,
+                "w":     w if kind == "slider" else 0,
+                "h":     h if kind == "slider" else 0,
+                "text":  str(text) if kind == "label" and param is None else None,
+                "src":   src,
+                "param": -1,
+            }
+
+            if param is not None:
+                elem["param"] = param_index
+                params.append(dict(param, index=param_index))
+                param_index += 1
+
+            elems.append(elem)
+
+        screens.append({"name": name, "elems": elems, "params": params})
+
+    if param_index > 127:
+        fail("too many params (%d)" % param_index)
+
+    return screens, images, param_index, font_kconfig
+
+
+def emit_header(screens, param_total):
+    out = []
+    out.append("/*")
+    out.append(" *   screens_gen.h - generated from screens.yaml by gen_screens.py.")
+    out.append(" *   Do not edit.")
+    out.append(" */")
+    out.append("#ifndef __SCREENS_GEN_H")
+    out.append("#define __SCREENS_GEN_H")
+    out.append("")
+    out.append('#include "screens.h"')
+    out.append("")
+    for i, scr in enumerate(screens):
+        out.append("#define SCREEN_ID_%-10s %d" % (scr["name"].upper(), i))
+    out.append("#define SCREEN_COUNT         %d" % len(screens))
+    out.append("#define SCREEN_PARAM_COUNT   %d" % param_total)
+    out.append("")
+    out.append("/* at least one slot, so the param arrays exist even with no params */")
+    out.append("#define SCREEN_PARAM_SLOTS   %d" % max(1, param_total))
+    out.append("")
+    out.append("extern const screen_desc_t   screen_descs[SCREEN_COUNT];")
+    out.append("extern lv_obj_t            * screen_objs[SCREEN_PARAM_SLOTS];")
+    out.append("extern short                 screen_values[SCREEN_PARAM_SLOTS];")
+    out.append("extern const param_t         screen_params[SCREEN_PARAM_SLOTS];")
+    out.append("")
+    out.append("#endif  /* __SCREENS_GEN_H */")
+    return "\n".join(out) + "\n"
+
+
+def emit_source(screens, images, param_total, font_kconfig):
+    out = []
+    out.append("/*")
+    out.append(" *   screens_gen.c - generated from screens.yaml by gen_screens.py.")
+    out.append(" *   Do not edit.")
+    out.append(" */")
+    out.append("#include <zephyr/toolchain.h>")
+    out.append("#include <zephyr/sys/util.h>")
+    out.append("")
+    out.append('#include "screens_gen.h"')
+    out.append("")
+    out.append("/* label sizes were computed from the screens.yaml font metrics */")
+    out.append("BUILD_ASSERT(IS_ENABLED(CONFIG_%s)," % font_kconfig)
+    out.append('             "screens.yaml font metrics assume CONFIG_%s");' % font_kconfig)
+    out.append("")
+    for img in images:
+        out.append("LV_IMG_DECLARE(%s);" % img)
+    if images:
+        out.append("")
+
+    values = [str(p["value"]) for s in screens for p in s["params"]] or ["0"]
+    out.append("lv_obj_t * screen_objs[SCREEN_PARAM_SLOTS];")
+    out.append("short      screen_values[SCREEN_PARAM_SLOTS] = { %s };" % ", ".join(values))
+    out.append("")
+
+    for scr in screens:
+        name = scr["name"]
+        out.append("static const screen_elem_t %s_elems[] = {" % name)
+        for e in scr["elems"]:
+            text = c_string(e["text"]) if e["text"] is not None else "NULL"
+            src = "&" + e["src"] if e["src"] else "NULL"
+            out.append("    { .type = %s, .param = %d, .x = %d, .y = %d, .w = %d, .h = %d, "
+                       ".text = %s, .src = %s }," %
+                       (KINDS[e["kind"]], e["param"], e["x"], e["y"], e["w"], e["h"], text, src))
+        out.append("};")
+        out.append("")
+
+    out.append("const param_t screen_params[SCREEN_PARAM_SLOTS] = {")
+    for scr in screens:
+        for p in scr["params"]:
+            out.append("    { .object = &screen_objs[%d], .value = &screen_values[%d], "
+                       ".step = %d, .max = %d, .min = %d }," %
+                       (p["index"], p["index"], p["step"], p["max"], p["min"]))
+    if not param_total:
+        out.append("    { .object = NULL, .value = NULL, .step = 0, .max = 0, .min = 0 },")
+    out.append("};")
+    out.append("")
+
+    out.append("const screen_desc_t screen_descs[SCREEN_COUNT] = {")
+    for scr in screens:
+        name = scr["name"]
+        if scr["params"]:
+            params = "&screen_params[%d]" % scr["params"][0]["index"]
+        else:
+            params = "NULL"
+        out.append("    { .elems = %s_elems, .elem_count = %d, .param_count = %d, .params = %s }," %
+                   (name, len(scr["elems"]), len(scr["params"]), params))
+    out.append("};")
+    return "\n".join(out) + "\n"
+
+
+def write(path, text):
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def emit_depfile(outputs, inputs):
+    # Make-style depfile so icon edits re-run the generator (CMake DEPFILE).
+    def esc(path):
+        return os.path.abspath(path).replace(" ", "\\ ")
+    return "%s: %s\n" % (" ".join(esc(p) for p in outputs),
+                         " ".join(esc(p) for p in inputs))
+
+
+def main():
+    if len(sys.argv) != 4:
+        fail("usage: gen_screens.py <screens.yaml> <icon source dir> <output dir>")
+
+    yaml_path, icon_dir, out_dir = sys.argv[1:]
+
+    try:
+        with open(yaml_path) as f:
+            layout = yaml.safe_load(f)
+    except (OSError, yaml.YAMLError) as e:
+        fail("cannot load %s: %s" % (yaml_path, e))
+
+    screens, images, param_total, font_kconfig = compile_layout(layout, icon_dir)
+
+    out_h = os.path.join(out_dir, "screens_gen.h")
+    out_c = os.path.join(out_dir, "screens_gen.c")
+
+    os.makedirs(out_dir, exist_ok=True)
+    write(out_h, emit_header(screens, param_total))
+    write(out_c, emit_source(screens, images, param_total, font_kconfig))
+    write(os.path.join(out_dir, "screens_gen.d"),
+          emit_depfile([out_c, out_h],
+                       [yaml_path] + [os.path.join(icon_dir, i + ".c") for i in images]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,265 @@
+/*
+ *   mirror.c - Remote display mirror over RTT.
+ *
+ *   Hooks the LVGL flush callback, keeps a shadow copy of the panel and,
+ *   at the end of each refresh, sends it as a run-length encoded XOR
+ *   delta (or a periodic keyframe) on a dedicated RTT up-buffer.
+ *   See mirror.h for the stream format and mirror_host.py for the viewer.
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/sys/byteorder.h>
+#include <lvgl.h>
+#include <string.h>
+#include <SEGGER_RTT.h>
+
+#include "mirror.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(mirror, 3);
+
+/*---------------------------------------------------------------------------*/
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+
+#define MIRROR_WIDTH        DT_PROP(DT_CHOSEN(zephyr_display), width)
+#define MIRROR_HEIGHT       DT_PROP(DT_CHOSEN(zephyr_display), height)
+#define MIRROR_FRAME_SIZE   (MIRROR_WIDTH * MIRROR_HEIGHT / 8)
+
+/* worst case RLE: one control byte per 128 literal bytes */
+#define MIRROR_PKT_SIZE     (MIRROR_HDR_SIZE + MIRROR_FRAME_SIZE + \
+                             (MIRROR_FRAME_SIZE + 127) / 128)
+
+#define MIRROR_RLE_MAX      128
+
+BUILD_ASSERT(CONFIG_DISPLAY_MIRROR_RTT_BUFFER < CONFIG_SEGGER_RTT_MAX_NUM_UP_BUFFERS,
+             "DISPLAY_MIRROR_RTT_BUFFER exceeds SEGGER_RTT_MAX_NUM_UP_BUFFERS");
+BUILD_ASSERT(CONFIG_DISPLAY_MIRROR_RTT_BUFFER_SIZE > MIRROR_PKT_SIZE,
+             "DISPLAY_MIRROR_RTT_BUFFER_SIZE cannot hold a keyframe");
+BUILD_ASSERT((MIRROR_HEIGHT % 8) == 0, "display height must be a multiple of 8");
+
+typedef struct {
+    bool             active;
+    void          (* flush_cb)(lv_disp_drv_t * drv, const lv_area_t * area,
+                               lv_color_t * color_p);
+    uint8_t          flags;
+    uint8_t          seq;
+    bool             dirty;
+    uint32_t         key_time;
+    uint8_t          frame [MIRROR_FRAME_SIZE];   /* what the panel shows  */
+    uint8_t          sent  [MIRROR_FRAME_SIZE];   /* what the host has     */
+    uint8_t          pkt   [MIRROR_PKT_SIZE];
+} mirror_t;
+
+static mirror_t mirror;
+
+static uint8_t rtt_buffer [CONFIG_DISPLAY_MIRROR_RTT_BUFFER_SIZE];
+
+/*---------------------------------------------------------------------------*/
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+static size_t mirror_rle(const uint8_t * src, size_t len, uint8_t * dst)
+{
+    size_t i = 0;
+    size_t o = 0;
+
+    while (i < len) {
+
+        size_t run = 1;
+        while (i + run < len && run < MIRROR_RLE_MAX && src[i + run] == src[i])
+            run++;
+
+        if (run >= 3) {
+            dst[o++] = 0x80 | (run - 1);
+            dst[o++] = src[i];
+            i += run;
+            continue;
+        }
+
+        /* literal block: up to the next run of three or more */
+        size_t start = i;
+        size_t count = 0;
+        while (i < len && count < MIRROR_RLE_MAX) {
+            if (i + 2 < len && src[i] == src[i + 1] && src[i] == src[i + 2])
+                break;
+            i++;
+            count++;
+        }
+        dst[o++] = count - 1;
+        memcpy(&dst[o], &src[start], count);
+        o += count;
+    }
+
+    return o;
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+static void mirror_send(bool key)
+{
+    const uint8_t * payload = mirror.frame;
+    uint8_t       * pkt     = mirror.pkt;
+
+    /*
+     *  Don't encode until the host has drained room for a worst-case
+     *  packet; with no host attached this leaves only the shadow copy in
+     *  the flush path.  'dirty' stays set and mirror_tick() retries.
+     */
+    if (SEGGER_RTT_GetAvailWriteSpace(CONFIG_DISPLAY_MIRROR_RTT_BUFFER) < MIRROR_PKT_SIZE)
+        return;
+
+    /*
+     *  Deltas are XORed into 'sent' in place (no separate delta buffer);
+     *  XORing the frame in again restores it if the write is skipped.
+     */
+    if (!key) {
+        uint8_t changed = 0;
+        for (int i = 0; i < MIRROR_FRAME_SIZE; i++) {
+            mirror.sent[i] ^= mirror.frame[i];
+            changed |= mirror.sent[i];
+        }
+        if (!changed) {
+            /* all zero: frame == sent, restore it */
+            memcpy(mirror.sent, mirror.frame, MIRROR_FRAME_SIZE);
+            mirror.dirty = false;
+            return;
+        }
+        payload = mirror.sent;
+    }
+
+    size_t len = mirror_rle(payload, MIRROR_FRAME_SIZE, &pkt[MIRROR_HDR_SIZE]);
+
+    pkt[0]  = MIRROR_MAGIC0;
+    pkt[1]  = MIRROR_MAGIC1;
+    pkt[2]  = key ? MIRROR_TYPE_KEY : MIRROR_TYPE_DELTA;
+    pkt[3]  = mirror.seq;
+    sys_put_le16(MIRROR_WIDTH,  &pkt[4]);
+    sys_put_le16(MIRROR_HEIGHT, &pkt[6]);
+    pkt[8]  = mirror.flags;
+    pkt[9]  = 0;
+    sys_put_le16(len, &pkt[10]);
+
+    /*
+     *  No-block-skip: either the whole packet fits or nothing is written.
+     *  On a skip 'sent' is restored, so the next delta is still taken
+     *  against what the host actually has.
+     */
+    if (SEGGER_RTT_Write(CONFIG_DISPLAY_MIRROR_RTT_BUFFER, pkt,
+                         MIRROR_HDR_SIZE + len) == 0) {
+        if (!key) {
+            for (int i = 0; i < MIRROR_FRAME_SIZE; i++)
+                mirror.sent[i] ^= mirror.frame[i];
+        }
+        return;
+    }
+
+    memcpy(mirror.sent, mirror.frame, MIRROR_FRAME_SIZE);
+    mirror.seq++;
+    mirror.dirty = false;
+
+    if (key)
+        mirror.key_time = k_uptime_get_32();
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+static bool mirror_key_due(void)
+{
+    return (k_uptime_get_32() - mirror.key_time) >= CONFIG_DISPLAY_MIRROR_KEYFRAME_MS;
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*
+ *  Wraps the driver's flush: copy the area into the shadow frame, pass it
+ *  on, and emit a packet once the last area of the refresh is flushed.
+ */
+static void mirror_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area,
+                            lv_color_t * color_p)
+{
+    const uint8_t * src  = (const uint8_t *) color_p;
+    uint16_t        w    = lv_area_get_width(area);
+    bool            last = lv_disp_flush_is_last(drv);
+
+    /* area is page aligned by the vtiled rounder: one row of bytes per page */
+    for (int y = area->y1; y <= area->y2; y += 8) {
+        memcpy(&mirror.frame[(y / 8) * MIRROR_WIDTH + area->x1], src, w);
+        src += w;
+    }
+    mirror.dirty = true;
+
+    mirror.flush_cb(drv, area, color_p);
+
+    if (last)
+        mirror_send(mirror_key_due());
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*
+ *  Called from the display task: retry a skipped frame and resend keyframes
+ *  while the screen is idle, so a host attaching late still gets a picture.
+ */
+void mirror_tick(void)
+{
+    if (!mirror.active)
+        return;
+
+    if (!mirror.dirty && !mirror_key_due())
+        return;
+
+    mirror_send(mirror_key_due());
+}
+
+/*---------------------------------------------------------------------------*/
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+int mirror_init(const struct device * display_dev)
+{
+    struct display_capabilities caps;
+    lv_disp_t * disp = lv_disp_get_default();
+
+    if (disp == NULL) {
+        LOG_ERR("No LVGL display.");
+        return -1;
+    }
+
+    display_get_capabilities(display_dev, &caps);
+
+    if ((caps.screen_info & SCREEN_INFO_MONO_VTILED) == 0 ||
+        (caps.current_pixel_format != PIXEL_FORMAT_MONO01 &&
+         caps.current_pixel_format != PIXEL_FORMAT_MONO10)) {
+        LOG_ERR("Mirror needs a vtiled mono display.");
+        return -1;
+    }
+
+    if (caps.x_resolution != MIRROR_WIDTH || caps.y_resolution != MIRROR_HEIGHT) {
+        LOG_ERR("Mirror resolution mismatch: %ux%u", caps.x_resolution, caps.y_resolution);
+        return -1;
+    }
+
+    mirror.flags = 0;
+    if (caps.screen_info & SCREEN_INFO_MONO_MSB_FIRST)
+        mirror.flags |= MIRROR_FLAG_MSB_FIRST;
+    if (caps.current_pixel_format == PIXEL_FORMAT_MONO01)
+        mirror.flags |= MIRROR_FLAG_MONO01;
+
+    SEGGER_RTT_ConfigUpBuffer(CONFIG_DISPLAY_MIRROR_RTT_BUFFER, "mirror",
+                              rtt_buffer, sizeof(rtt_buffer),
+                              SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+
+    mirror.active   = true;
+    mirror.flush_cb = disp->driver->flush_cb;
+    mirror.key_time = k_uptime_get_32() - CONFIG_DISPLAY_MIRROR_KEYFRAME_MS;
+    disp->driver->flush_cb = mirror_flush_cb;
+
+    LOG_INF("Mirror on RTT up-buffer %d (%dx%d)",
+            CONFIG_DISPLAY_MIRROR_RTT_BUFFER, MIRROR_WIDTH, MIRROR_HEIGHT);
+
+    return 0;
+}
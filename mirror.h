@@ -0,0 +1,55 @@
+/*
+ *   mirror.h
+ */
+#ifndef __MIRROR_H
+#define __MIRROR_H
+
+#include <zephyr/device.h>
+
+/*
+ *  Stream format, one packet per mirrored frame (little-endian):
+ *
+ *    0  'M' 'R'       magic
+ *    2  type          MIRROR_TYPE_KEY or MIRROR_TYPE_DELTA
+ *    3  seq           increments per packet sent
+ *    4  width  (u16)
+ *    6  height (u16)
+ *    8  flags         MIRROR_FLAG_*
+ *    9  reserved
+ *   10  length (u16)  payload bytes that follow
+ *
+ *  The payload is the run-length encoded frame (keyframe) or the XOR of
+ *  the frame against the previous packet's frame (delta).  RLE control
+ *  byte c: bit7 set -> repeat next byte (c & 0x7F) + 1 times; clear ->
+ *  copy the next c + 1 bytes literally.
+ *
+ *  The frame is the panel's native 1bpp vertically tiled layout: byte
+ *  (y / 8) * width + x, bit y % 8 (bit 7 first if MIRROR_FLAG_MSB_FIRST).
+ *  Bit polarity follows the panel's pixel format: on MONO10 a 1 bit is a
+ *  lit pixel, on MONO01 (MIRROR_FLAG_MONO01 set) a 1 bit is black.
+ */
+#define MIRROR_MAGIC0           'M'
+#define MIRROR_MAGIC1           'R'
+#define MIRROR_TYPE_KEY         'K'
+#define MIRROR_TYPE_DELTA       'D'
+#define MIRROR_HDR_SIZE         12
+
+#define MIRROR_FLAG_MSB_FIRST   0x01
+#define MIRROR_FLAG_MONO01      0x02
+
+/*---------------------------------------------------------------------------*/
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+#if defined(CONFIG_DISPLAY_MIRROR)
+
+int  mirror_init(const struct device * display_dev);
+void mirror_tick(void);
+
+#else
+
+static inline int  mirror_init(const struct device * display_dev) { return 0; }
+static inline void mirror_tick(void) { }
+
+#endif
+
+#endif  /* __MIRROR_H */
@@ -0,0 +1,13 @@
+#!/bin/sh
+# script to view the display mirror via JLinkRTTLogger
+#
+# usage: mirror.sh [channel] [capture file]
+#   channel must match CONFIG_DISPLAY_MIRROR_RTT_BUFFER (default 1)
+#
+CHANNEL=${1:-1}
+OUT=${2:-/tmp/mirror.rtt}
+HOST="$(dirname "$0")/mirror_host.py"
+rm -f "$OUT"
+xterm -title 'JLinkRTTLogger' -e bash -c "JLinkRTTLogger -Device NRF52832_XXAA -If SWD -Speed 1000 -RTTChannel '$CHANNEL' '$OUT'" &
+sleep 1
+xterm -title 'Display Mirror' -geometry 132x20 -e bash -c "python3 '$HOST' --follow '$OUT'" &
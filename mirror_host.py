@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+#
+#  mirror_host.py - Reconstruct the display mirror stream (see mirror.h).
+#
+#  Reads the raw RTT mirror channel from a file (e.g. the output of
+#  JLinkRTTLogger; with --follow it keeps reading as the file grows) or from
+#  stdin, and draws each frame in the terminal.  With --record, every frame
+#  is also written as a PBM.
+#
+#  usage: mirror_host.py [--follow] [--record DIR] [--no-view] [FILE | -]
+#
+
+import argparse
+import os
+import sys
+import time
+
+MAGIC = b"MR"
+HDR_SIZE = 12
+TYPE_KEY = ord("K")
+TYPE_DELTA = ord("D")
+FLAG_MSB_FIRST = 0x01
+FLAG_MONO01 = 0x02
+
+
+def rle_decode(data, size):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        c = data[i]
+        i += 1
+        if c & 0x80:
+            out += bytes([data[i]]) * ((c & 0x7F) + 1)
+            i += 1
+        else:
+            out += data[i:i + c + 1]
+            i += c + 1
+    if len(out) != size:
+        raise ValueError("decoded %d bytes, expected %d" % (len(out), size))
+    return out
+
+
+def pixel(frame, width, flags, x, y):
+    """Return 1 if the pixel is lit on the panel, whatever the raw polarity."""
+    byte = frame[(y // 8) * width + x]
+    bit = 7 - (y % 8) if flags & FLAG_MSB_FIRST else y % 8
+    value = (byte >> bit) & 1
+    # MONO10: 1 = lit, MONO01: 1 = black
+    return value ^ 1 if flags & FLAG_MONO01 else value
+
+
+def render(frame, width, height, flags):
+    # Two pixel rows per text line using half blocks.
+    lines = []
+    for y in range(0, height, 2):
+        row = []
+        for x in range(width):
+            top = pixel(frame, width, flags, x, y)
+            bot = pixel(frame, width, flags, x, y + 1) if y + 1 < height else 0
+            row.append(" ▀▄█"[top | (bot << 1)])
+        lines.append("".join(row))
+    return lines
+
+
+def write_pbm(path, frame, width, height, flags):
+    with open(path, "w") as f:
+        f.write("P1\n%d %d\n" % (width, height))
+        for y in range(height):
+            # P1 uses 1 = black, so lit pixels are written as 0 (white)
+            f.write(" ".join(str(1 - pixel(frame, width, flags, x, y))
+                             for x in range(width)) + "\n")
+
+
+class Decoder:
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.frame = None
+        self.seq = None
+        self.stats = {"key": 0, "delta": 0, "bytes": 0, "resync": 0}
+
+    def feed(self, data):
+        """Append raw bytes; yield (frame, width, height, flags) per frame."""
+        self.buf += data
+        while True:
+            start = self.buf.find(MAGIC)
+            if start < 0:
+                del self.buf[:max(0, len(self.buf) - 1)]
+                return
+            if start:
+                del self.buf[:start]
+                self.stats["resync"] += 1
+            if len(self.buf) < HDR_SIZE:
+                return
+
+            ptype, seq = self.buf[2], self.buf[3]
+            width = int.from_bytes(self.buf[4:6], "little")
+            height = int.from_bytes(self.buf[6:8], "little")
+            flags = self.buf[8]
+            length = int.from_bytes(self.buf[10:12], "little")
+            size = width * height // 8
+
+            if ptype not in (TYPE_KEY, TYPE_DELTA) or size == 0 or length > 2 * size:
+                del self.buf[:2]
+                self.stats["resync"] += 1
+                continue
+            if len(self.buf) < HDR_SIZE + length:
+                return
+
+            payload = bytes(self.buf[HDR_SIZE:HDR_SIZE + length])
+            del self.buf[:HDR_SIZE + length]
+            self.stats["bytes"] += HDR_SIZE + length
+
+            try:
+                data = rle_decode(payload, size)
+            except (ValueError, IndexError):
+                self.frame = None
+                self.stats["resync"] += 1
+                continue
+
+            if ptype == TYPE_KEY:
+                self.frame = bytearray(data)
+                self.stats["key"] += 1
+            else:
+                # A delta is only usable on top of the frame just before it.
+                if self.frame is None or len(self.frame) != size or \
+                   self.seq is None or seq != (self.seq + 1) & 0xFF:
+                    self.frame = None
+                    self.seq = seq
+                    continue
+                for i, d in enumerate(data):
+                    self.frame[i] ^= d
+                self.stats["delta"] += 1
+
+            self.seq = seq
+            yield bytes(self.frame), width, height, flags
+
+
+def read_stream(path, follow):
+    if path == "-":
+        stream = sys.stdin.buffer
+        while True:
+            data = stream.read1(4096) if hasattr(stream, "read1") else stream.read(4096)
+            if not data:
+                return
+            yield data
+    else:
+        while follow and not os.path.exists(path):
+            time.sleep(0.2)
+        with open(path, "rb") as f:
+            while True:
+                data = f.read(4096)
+                if data:
+                    yield data
+                elif follow:
+                    time.sleep(0.05)
+                else:
+                    return
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Display mirror viewer/recorder")
+    parser.add_argument("input", nargs="?", default="-",
+                        help="raw mirror channel file, or - for stdin")
+    parser.add_argument("--follow", action="store_true",
+                        help="keep reading FILE as it grows (live capture)")
+    parser.add_argument("--record", metavar="DIR",
+                        help="write every frame as DIR/frame_NNNNNN.pbm")
+    parser.add_argument("--no-view", action="store_true",
+                        help="do not draw frames in the terminal")
+    args = parser.parse_args()
+
+    if args.input != "-" and not args.follow and not os.path.exists(args.input):
+        sys.exit("mirror_host: cannot open %s" % args.input)
+
+    if args.record:
+        os.makedirs(args.record, exist_ok=True)
+
+    dec = Decoder()
+    count = 0
+    try:
+        for data in read_stream(args.input, args.follow):
+            for frame, width, height, flags in dec.feed(data):
+                if args.record:
+                    write_pbm(os.path.join(args.record, "frame_%06d.pbm" % count),
+                              frame, width, height, flags)
+                if not args.no_view:
+                    lines = render(frame, width, height, flags)
+                    sys.stdout.write("\x1b[H\x1b[2J" + "\n".join(lines) + "\n")
+                    sys.stdout.write("frame %d  key %d  delta %d  bytes %d  resync %d\n" %
+                                     (count, dec.stats["key"], dec.stats["delta"],
+                                      dec.stats["bytes"], dec.stats["resync"]))
+                    sys.stdout.flush()
+                count += 1
+    except KeyboardInterrupt:
+        pass
+
+    print("%d frames, %s" % (count, dec.stats), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,52 @@
+/*
+ *   screens.h
+ *
+ *   Types for the screen tables generated from screens.yaml by gen_screens.py.
+ */
+#ifndef __SCREENS_H
+#define __SCREENS_H
+
+#include <lvgl.h>
+
+/*---------------------------------------------------------------------------*/
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+
+#define SCREEN_NO_PARAM   (-1)
+
+typedef enum {
+    SCREEN_ELEM_LABEL  = 0,
+    SCREEN_ELEM_SLIDER = 1,
+    SCREEN_ELEM_IMAGE  = 2,
+} screen_elem_type_t;
+
+typedef struct {
+    lv_obj_t     ** object;
+    short         * value;
+    short           step;
+    short           max;
+    short           min;
+} param_t;
+
+/*
+ *  One object on a screen; x/y are absolute (already aligned) coordinates.
+ */
+typedef struct {
+    uint8_t                type;     /* screen_elem_type_t */
+    int8_t                 param;    /* index into screen_objs, or SCREEN_NO_PARAM */
+    lv_coord_t             x;
+    lv_coord_t             y;
+    lv_coord_t             w;        /* slider only */
+    lv_coord_t             h;        /* slider only */
+    const char           * text;     /* label only */
+    const lv_img_dsc_t   * src;      /* image only */
+} screen_elem_t;
+
+typedef struct {
+    const screen_elem_t  * elems;
+    uint8_t                elem_count;
+    uint8_t                param_count;
+    const param_t        * params;
+} screen_desc_t;
+
+#endif  /* __SCREENS_H */